@@ -1,6 +1,11 @@
 #pragma once
 
+#include <cstdint>
 #include <cstdio>
+#include <memory>
+#include <new>
+#include <utility>
+#include "buffer_cache.h"
 
 template<typename Type>
 class ArrayPtr {
@@ -9,8 +14,25 @@ public:
     ArrayPtr() = default;
 
     // Создаёт в куче массив из size элементов типа Type.
-    // Если size == 0, поле raw_ptr_ должно быть равно nullptr
-    explicit ArrayPtr(size_t size) : raw_ptr_(size == 0 ? nullptr : new Type[size]) {
+    // Если size == 0, поле raw_ptr_ должно быть равно nullptr.
+    // Если включён BufferCache, память берётся из кэша буферов
+    explicit ArrayPtr(size_t size) {
+        if (size == 0) return;
+        if (alignof(Type) <= __STDCPP_DEFAULT_NEW_ALIGNMENT__ && BufferCache::IsEnabled()) {
+            // Как и new[], отказываемся выделять массив, размер которого в байтах не помещается в size_t
+            if (size > SIZE_MAX / sizeof(Type)) throw std::bad_array_new_length();
+            auto *data = static_cast<Type *>(BufferCache::Allocate(size * sizeof(Type)));
+            try {
+                std::uninitialized_default_construct_n(data, size);
+            } catch (...) {
+                BufferCache::Deallocate(data, size * sizeof(Type));
+                throw;
+            }
+            raw_ptr_ = data;
+            cached_size_ = size;
+        } else {
+            raw_ptr_ = new Type[size];
+        }
     }
 
     // Конструктор из сырого указателя, хранящего адрес массива в куче либо nullptr
@@ -24,7 +46,7 @@ public:
     }
 
     ~ArrayPtr() {
-        delete[] raw_ptr_;
+        Free();
     }
 
     // Запрещаем присваивание
@@ -36,10 +58,14 @@ public:
     }
 
     // Прекращает владением массивом в памяти, возвращает значение адреса массива
-    // После вызова метода указатель на массив должен обнулиться
-    [[nodiscard]] Type *Release()
-
-    noexcept {
+    // После вызова метода указатель на массив должен обнулиться.
+    // Массив из кэша буферов перед этим переносится в память, выделенную через new[]
+    [[nodiscard]] Type *Release() {
+        if (cached_size_ != 0) {
+            ArrayPtr tmp(new Type[cached_size_]);
+            std::move(raw_ptr_, raw_ptr_ + cached_size_, tmp.Get());
+            swap(tmp);
+        }
         return std::exchange(raw_ptr_, nullptr);
     }
 
@@ -74,8 +100,21 @@ public:
 
     noexcept {
         std::swap(raw_ptr_, other.raw_ptr_);
+        std::swap(cached_size_, other.cached_size_);
+    }
+
+private:
+    void Free() noexcept {
+        if (cached_size_ != 0) {
+            std::destroy_n(raw_ptr_, cached_size_);
+            BufferCache::Deallocate(raw_ptr_, cached_size_ * sizeof(Type));
+        } else {
+            delete[] raw_ptr_;
+        }
     }
 
 private:
     Type *raw_ptr_ = nullptr;
+    // Количество элементов, если массив взят из кэша буферов, иначе 0
+    size_t cached_size_ = 0;
 };
@@ -0,0 +1,34 @@
+#pragma once
+
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+
+// Замеряет время выполнения func в миллисекундах
+template<typename Func>
+double MeasureMs(Func func) {
+    const auto start = std::chrono::steady_clock::now();
+    func();
+    const auto finish = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::milli>(finish - start).count();
+}
+
+// Печатает строку таблицы результатов: название замера и значение с единицами измерения
+inline void PrintResult(const std::string &name, double value, const std::string &unit) {
+    std::cout << "  " << std::left << std::setw(40) << name
+              << std::right << std::setw(12) << std::fixed << std::setprecision(2) << value
+              << ' ' << unit << std::endl;
+}
+
+// Возвращает числовой аргумент командной строки с номером index либо default_value
+inline size_t GetArgument(int argc, char *argv[], int index, size_t default_value) {
+    return index < argc ? std::strtoull(argv[index], nullptr, 10) : default_value;
+}
+
+// Не даёт компилятору выбросить вычисление value как неиспользуемое
+template<typename Type>
+void DoNotOptimize(const Type &value) {
+    asm volatile("" : : "r,m"(value) : "memory");
+}
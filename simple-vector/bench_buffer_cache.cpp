@@ -0,0 +1,63 @@
+// Создание и уничтожение SimpleVector в нескольких потоках с выключенным и включённым BufferCache.
+// Сборка: g++ -std=c++17 -O2 -pthread bench_buffer_cache.cpp -o bench_buffer_cache
+// Запуск: ./bench_buffer_cache [итераций на поток, по умолчанию 1000000] [наибольшее число потоков]
+
+#include "bench.h"
+#include "buffer_cache.h"
+#include "simple_vector.h"
+
+#include <random>
+#include <thread>
+
+using namespace std;
+
+// Каждый поток iterations раз создаёт вектор случайного размера от 16 до 4096 элементов,
+// заполняет несколько элементов и уничтожает его. Возвращает общее время в миллисекундах
+double MeasureChurn(size_t threads_count, size_t iterations) {
+    return MeasureMs([&] {
+        SimpleVector<thread> threads;
+        for (size_t t = 0; t < threads_count; ++t) {
+            threads.PushBack(thread([iterations, t] {
+                mt19937 gen(static_cast<unsigned>(t));
+                uniform_int_distribution<size_t> size_dist(16, 4096);
+                for (size_t i = 0; i < iterations; ++i) {
+                    SimpleVector<int> v;
+                    v.Reserve(size_dist(gen));
+                    for (int j = 0; j < 8; ++j) {
+                        v.PushBack(j);
+                    }
+                    DoNotOptimize(v[7]);
+                }
+            }));
+        }
+        for (auto &t: threads) {
+            t.join();
+        }
+    });
+}
+
+int main(int argc, char *argv[]) {
+    const size_t iterations = GetArgument(argc, argv, 1, 1000000);
+    const size_t max_threads = GetArgument(argc, argv, 2, max(thread::hardware_concurrency(), 1u));
+    cout << "Iterations per thread: "s << iterations << endl << endl;
+
+    for (size_t threads = 1; threads <= max_threads; threads *= 2) {
+        cout << threads << " thread(s)"s << endl;
+
+        BufferCache::Enable(false);
+        PrintResult("new[] / delete[]"s, MeasureChurn(threads, iterations), "ms"s);
+
+        BufferCache::Enable();
+        BufferCache::Trim();
+        BufferCache::ResetStats();
+        PrintResult("BufferCache"s, MeasureChurn(threads, iterations), "ms"s);
+
+        const auto stats = BufferCache::GetStats();
+        cout << "  hits: "s << stats.hits << ", misses: "s << stats.misses
+             << ", evictions: "s << stats.evictions << endl;
+        cout << endl;
+    }
+    BufferCache::Enable(false);
+    BufferCache::Trim();
+    return 0;
+}
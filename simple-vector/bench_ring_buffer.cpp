@@ -0,0 +1,159 @@
+// Пропускная способность и задержка SpscQueue и MpmcQueue в сравнении с обменом
+// SimpleVector под мьютексом.
+// Сборка: g++ -std=c++17 -O2 -pthread bench_ring_buffer.cpp -o bench_ring_buffer
+// Запуск: ./bench_ring_buffer [количество элементов, по умолчанию 10000000] [наибольшее число потоков]
+
+#include "bench.h"
+#include "ring_buffer.h"
+#include "simple_vector.h"
+
+#include <atomic>
+#include <cassert>
+#include <mutex>
+#include <thread>
+
+using namespace std;
+
+constexpr size_t kQueueCapacity = 4096;
+
+// Очередь, в которой производители дописывают элементы в общий SimpleVector под мьютексом,
+// а потребитель забирает их все разом обменом векторов
+class MutexSwapQueue {
+public:
+    explicit MutexSwapQueue(size_t) {
+    }
+
+    size_t TryPushN(const uint64_t *first, const uint64_t *last) {
+        lock_guard guard(mutex_);
+        for (auto it = first; it != last; ++it) {
+            items_.PushBack(*it);
+        }
+        return last - first;
+    }
+
+    size_t TryPopN(SimpleVector<uint64_t> &out, size_t) {
+        {
+            lock_guard guard(mutex_);
+            items_.swap(spare_);
+        }
+        for (auto item: spare_) {
+            out.PushBack(item);
+        }
+        const size_t count = spare_.GetSize();
+        spare_.Clear();
+        return count;
+    }
+
+private:
+    mutex mutex_;
+    SimpleVector<uint64_t> items_;
+    // Используется только потребителем
+    SimpleVector<uint64_t> spare_;
+};
+
+// Передаёт count элементов от producers производителей к consumers потребителям
+// пакетами по batch элементов и возвращает пропускную способность в млн элементов в секунду
+template<typename Queue>
+double MeasureThroughput(size_t count, size_t producers, size_t consumers, size_t batch) {
+    Queue queue(kQueueCapacity);
+    atomic<size_t> popped = 0;
+    atomic<uint64_t> sum = 0;
+
+    const double ms = MeasureMs([&] {
+        SimpleVector<thread> threads;
+        for (size_t p = 0; p < producers; ++p) {
+            threads.PushBack(thread([&, p] {
+                SimpleVector<uint64_t> items(::Reserve(batch));
+                for (size_t i = p; i < count; i += producers) {
+                    items.PushBack(i);
+                    if (items.GetSize() == batch || i + producers >= count) {
+                        const uint64_t *first = items.begin();
+                        while (first != items.end()) {
+                            const size_t pushed = queue.TryPushN(first, items.end());
+                            if (pushed == 0) this_thread::yield();
+                            first += pushed;
+                        }
+                        items.Clear();
+                    }
+                }
+            }));
+        }
+        for (size_t c = 0; c < consumers; ++c) {
+            threads.PushBack(thread([&] {
+                SimpleVector<uint64_t> out;
+                uint64_t local_sum = 0;
+                while (popped.load(memory_order_relaxed) < count) {
+                    out.Clear();
+                    const size_t n = queue.TryPopN(out, batch);
+                    if (n == 0) {
+                        this_thread::yield();
+                        continue;
+                    }
+                    for (auto item: out) {
+                        local_sum += item;
+                    }
+                    popped.fetch_add(n, memory_order_relaxed);
+                }
+                sum += local_sum;
+            }));
+        }
+        for (auto &t: threads) {
+            t.join();
+        }
+    });
+
+    assert(sum == uint64_t(count) * (count - 1) / 2);
+    return count / ms / 1000.0;
+}
+
+// Гоняет один элемент туда и обратно через пару очередей и возвращает среднюю
+// задержку передачи в одну сторону в наносекундах
+template<typename Queue>
+double MeasureLatency(size_t rounds) {
+    Queue ping(kQueueCapacity);
+    Queue pong(kQueueCapacity);
+
+    thread echo([&] {
+        uint64_t item;
+        for (size_t i = 0; i < rounds; ++i) {
+            while (!ping.TryPop(item)) this_thread::yield();
+            while (!pong.TryPush(item)) this_thread::yield();
+        }
+    });
+
+    const double ms = MeasureMs([&] {
+        uint64_t item;
+        for (size_t i = 0; i < rounds; ++i) {
+            while (!ping.TryPush(i)) this_thread::yield();
+            while (!pong.TryPop(item)) this_thread::yield();
+            assert(item == i);
+        }
+    });
+    echo.join();
+    return ms * 1e6 / rounds / 2;
+}
+
+int main(int argc, char *argv[]) {
+    const size_t count = GetArgument(argc, argv, 1, 10000000);
+    const size_t max_threads = GetArgument(argc, argv, 2, max(thread::hardware_concurrency(), 2u));
+    cout << "Items: "s << count << endl << endl;
+
+    for (size_t batch: {1u, 64u}) {
+        cout << "Throughput, batch "s << batch << endl;
+        PrintResult("SpscQueue 1x1"s, MeasureThroughput<SpscQueue<uint64_t>>(count, 1, 1, batch), "M items/s"s);
+        for (size_t threads = 1; 2 * threads <= max_threads; threads *= 2) {
+            // Обмен векторами рассчитан на одного потребителя
+            PrintResult("MpmcQueue "s + to_string(threads) + "x"s + to_string(threads),
+                        MeasureThroughput<MpmcQueue<uint64_t>>(count, threads, threads, batch), "M items/s"s);
+            PrintResult("Mutex + swap "s + to_string(threads) + "x1"s,
+                        MeasureThroughput<MutexSwapQueue>(count, threads, 1, batch), "M items/s"s);
+        }
+        cout << endl;
+    }
+
+    const size_t rounds = count / 10;
+    cout << "One-way latency, "s << rounds << " round trips"s << endl;
+    PrintResult("SpscQueue"s, MeasureLatency<SpscQueue<uint64_t>>(rounds), "ns"s);
+    PrintResult("MpmcQueue"s, MeasureLatency<MpmcQueue<uint64_t>>(rounds), "ns"s);
+    return 0;
+}
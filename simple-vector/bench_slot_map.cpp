@@ -0,0 +1,108 @@
+// Вставка, обход, поиск и удаление в SlotMap в сравнении с std::unordered_map по идентификатору.
+// Сборка: g++ -std=c++17 -O2 bench_slot_map.cpp -o bench_slot_map
+// Запуск: ./bench_slot_map [количество сущностей, по умолчанию 1000000]
+
+#include "bench.h"
+#include "simple_vector.h"
+#include "slot_map.h"
+
+#include <algorithm>
+#include <random>
+#include <unordered_map>
+
+using namespace std;
+
+struct Entity {
+    uint64_t id = 0;
+    double x = 0;
+    double y = 0;
+    double z = 0;
+};
+
+// Возвращает индексы от 0 до size - 1 в случайном порядке
+SimpleVector<size_t> ShuffledIndices(size_t size) {
+    SimpleVector<size_t> indices(size);
+    for (size_t i = 0; i < size; ++i) {
+        indices[i] = i;
+    }
+    shuffle(indices.begin(), indices.end(), mt19937(42));
+    return indices;
+}
+
+double SumX(const SlotMap<Entity> &entities) {
+    double sum = 0;
+    for (const auto &entity: entities) {
+        sum += entity.x;
+    }
+    return sum;
+}
+
+double SumX(const unordered_map<uint64_t, Entity> &entities) {
+    double sum = 0;
+    for (const auto &[id, entity]: entities) {
+        sum += entity.x;
+    }
+    return sum;
+}
+
+void BenchSlotMap(size_t count, const SimpleVector<size_t> &order) {
+    cout << "SlotMap"s << endl;
+    SlotMap<Entity> entities;
+    SimpleVector<SlotMap<Entity>::Handle> handles(::Reserve(count));
+
+    PrintResult("insert"s, MeasureMs([&] {
+        for (size_t i = 0; i < count; ++i) {
+            handles.PushBack(entities.Insert(Entity{i, double(i), 0, 0}));
+        }
+    }), "ms"s);
+    PrintResult("iterate"s, MeasureMs([&] { DoNotOptimize(SumX(entities)); }), "ms"s);
+    PrintResult("lookup (random order)"s, MeasureMs([&] {
+        double sum = 0;
+        for (size_t i: order) {
+            sum += entities[handles[i]].x;
+        }
+        DoNotOptimize(sum);
+    }), "ms"s);
+    PrintResult("erase half (random order)"s, MeasureMs([&] {
+        for (size_t i = 0; i < count / 2; ++i) {
+            entities.Erase(handles[order[i]]);
+        }
+    }), "ms"s);
+    PrintResult("iterate after erase"s, MeasureMs([&] { DoNotOptimize(SumX(entities)); }), "ms"s);
+}
+
+void BenchUnorderedMap(size_t count, const SimpleVector<size_t> &order) {
+    cout << "std::unordered_map<uint64_t, Entity>"s << endl;
+    unordered_map<uint64_t, Entity> entities;
+
+    PrintResult("insert"s, MeasureMs([&] {
+        for (size_t i = 0; i < count; ++i) {
+            entities.emplace(i, Entity{i, double(i), 0, 0});
+        }
+    }), "ms"s);
+    PrintResult("iterate"s, MeasureMs([&] { DoNotOptimize(SumX(entities)); }), "ms"s);
+    PrintResult("lookup (random order)"s, MeasureMs([&] {
+        double sum = 0;
+        for (size_t i: order) {
+            sum += entities.at(i).x;
+        }
+        DoNotOptimize(sum);
+    }), "ms"s);
+    PrintResult("erase half (random order)"s, MeasureMs([&] {
+        for (size_t i = 0; i < count / 2; ++i) {
+            entities.erase(order[i]);
+        }
+    }), "ms"s);
+    PrintResult("iterate after erase"s, MeasureMs([&] { DoNotOptimize(SumX(entities)); }), "ms"s);
+}
+
+int main(int argc, char *argv[]) {
+    const size_t count = GetArgument(argc, argv, 1, 1000000);
+    cout << "Entities: "s << count << endl << endl;
+
+    const auto order = ShuffledIndices(count);
+    BenchSlotMap(count, order);
+    cout << endl;
+    BenchUnorderedMap(count, order);
+    return 0;
+}
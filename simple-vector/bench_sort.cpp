@@ -0,0 +1,83 @@
+// Сравнение RadixSort, ParallelSort и ParallelStableSort с std::sort и std::stable_sort.
+// Сборка: g++ -std=c++17 -O2 -pthread bench_sort.cpp -o bench_sort
+// Запуск: ./bench_sort [наибольший размер для uint32_t, по умолчанию 1000000000] [число потоков]
+//                     [наибольший размер для Record, по умолчанию 100000000]
+// Каждый замер держит в памяти три массива: исходные данные, сортируемую копию и буфер.
+// Для uint32_t это 12 байт на элемент (около 12 ГБ при 10^9 элементов),
+// для 16-байтных Record — 48 байт на элемент (около 4.8 ГБ при 10^8 и 48 ГБ при 10^9),
+// поэтому наибольший размер для Record задаётся отдельно
+
+#include "bench.h"
+#include "simple_vector.h"
+#include "sort.h"
+
+#include <algorithm>
+#include <cassert>
+#include <random>
+#include <thread>
+
+using namespace std;
+
+struct Record {
+    uint64_t key = 0;
+    uint64_t payload = 0;
+};
+
+template<typename Type, typename Sort>
+void BenchSort(const string &name, const SimpleVector<Type> &source, Sort sort_func) {
+    SimpleVector<Type> data(source);
+    const double ms = MeasureMs([&] { sort_func(data); });
+    DoNotOptimize(data[data.GetSize() / 2]);
+    PrintResult(name, ms, "ms"s);
+}
+
+void BenchKeys(size_t size, size_t threads) {
+    cout << "uint32_t, "s << size << " elements"s << endl;
+    mt19937 gen(42);
+    SimpleVector<uint32_t> source(size);
+    for (auto &item: source) {
+        item = gen();
+    }
+
+    SimpleVector<uint32_t> buffer;
+    BenchSort("std::sort"s, source, [](auto &v) { sort(v.begin(), v.end()); });
+    BenchSort("std::stable_sort"s, source, [](auto &v) { stable_sort(v.begin(), v.end()); });
+    BenchSort("RadixSort"s, source, [&](auto &v) { RadixSort(v, buffer); });
+    BenchSort("ParallelSort"s, source, [&](auto &v) { ParallelSort(v, buffer, less<>(), threads); });
+    BenchSort("ParallelStableSort"s, source, [&](auto &v) { ParallelStableSort(v, buffer, less<>(), threads); });
+}
+
+void BenchRecords(size_t size, size_t threads) {
+    cout << "Record {uint64_t key, payload}, "s << size << " elements"s << endl;
+    mt19937_64 gen(42);
+    SimpleVector<Record> source(size);
+    for (size_t i = 0; i < size; ++i) {
+        source[i] = {gen(), i};
+    }
+
+    auto by_key = [](const Record &lhs, const Record &rhs) { return lhs.key < rhs.key; };
+    SimpleVector<Record> buffer;
+    BenchSort("std::sort"s, source, [&](auto &v) { sort(v.begin(), v.end(), by_key); });
+    BenchSort("std::stable_sort"s, source, [&](auto &v) { stable_sort(v.begin(), v.end(), by_key); });
+    BenchSort("RadixSort (key extractor)"s, source, [&](auto &v) {
+        RadixSort(v, buffer, [](const Record &record) { return record.key; });
+    });
+    BenchSort("ParallelSort"s, source, [&](auto &v) { ParallelSort(v, buffer, by_key, threads); });
+    BenchSort("ParallelStableSort"s, source, [&](auto &v) { ParallelStableSort(v, buffer, by_key, threads); });
+}
+
+int main(int argc, char *argv[]) {
+    const size_t max_size = GetArgument(argc, argv, 1, 1000000000);
+    const size_t threads = GetArgument(argc, argv, 2, max(thread::hardware_concurrency(), 1u));
+    const size_t max_record_size = GetArgument(argc, argv, 3, 100000000);
+    cout << "Threads: "s << threads << endl << endl;
+
+    for (size_t size = 1000000; size <= max_size; size *= 10) {
+        BenchKeys(size, threads);
+        if (size <= max_record_size) {
+            BenchRecords(size, threads);
+        }
+        cout << endl;
+    }
+    return 0;
+}
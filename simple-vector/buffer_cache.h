@@ -0,0 +1,265 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <mutex>
+#include <new>
+#include <utility>
+
+// Статистика кэша буферов
+struct BufferCacheStats {
+    // Количество выделений, обслуженных из кэша
+    size_t hits = 0;
+    // Количество выделений, для которых пришлось обратиться к глобальному аллокатору
+    size_t misses = 0;
+    // Количество буферов, возвращённых глобальному аллокатору из-за переполнения кэша
+    size_t evictions = 0;
+};
+
+// Кэш освобождённых буферов, который переиспользуется ArrayPtr вместо new[] / delete[].
+// Буферы делятся на классы размеров по степеням двойки. У каждого потока есть собственный
+// кэш, ограниченный по суммарному объёму, а излишки уходят в общий для всех потоков пул.
+// По умолчанию кэш выключен и включается вызовом BufferCache::Enable()
+class BufferCache {
+public:
+    // Наименьший и наибольший кэшируемые размеры буфера: 2^kMinClassShift и 2^kMaxClassShift байт
+    static constexpr size_t kMinClassShift = 6;
+    static constexpr size_t kMaxClassShift = 24;
+    static constexpr size_t kClassCount = kMaxClassShift - kMinClassShift + 1;
+
+    static constexpr size_t kDefaultThreadCacheLimit = size_t(4) << 20;
+    static constexpr size_t kDefaultGlobalPoolLimit = size_t(64) << 20;
+
+    // Включает или выключает кэш для последующих выделений памяти
+    static void Enable(bool enabled = true) noexcept {
+        GetGlobalPool().enabled.store(enabled, std::memory_order_relaxed);
+    }
+
+    [[nodiscard]] static bool IsEnabled() noexcept {
+        return GetGlobalPool().enabled.load(std::memory_order_relaxed);
+    }
+
+    // Задаёт наибольший суммарный объём буферов в кэше каждого потока
+    static void SetThreadCacheLimit(size_t bytes) noexcept {
+        GetGlobalPool().thread_limit.store(bytes, std::memory_order_relaxed);
+    }
+
+    // Задаёт наибольший суммарный объём буферов в общем пуле
+    static void SetGlobalPoolLimit(size_t bytes) {
+        GlobalPool &pool = GetGlobalPool();
+        std::lock_guard guard(pool.mutex);
+        pool.limit = bytes;
+    }
+
+    // Выделяет буфер размером не меньше bytes байт.
+    // Буфер должен быть освобождён вызовом Deallocate с тем же значением bytes
+    [[nodiscard]] static void *Allocate(size_t bytes) {
+        const size_t index = ClassIndex(bytes);
+        if (index == kClassCount) {
+            return ::operator new(bytes);
+        }
+
+        ThreadCache *cache = GetThreadCache();
+        if (cache != nullptr && cache->free_lists[index] != nullptr) {
+            cache->bytes -= ClassSize(index);
+            cache->hits.fetch_add(1, std::memory_order_relaxed);
+            return PopBlock(cache->free_lists[index]);
+        }
+
+        GlobalPool &pool = GetGlobalPool();
+        {
+            std::lock_guard guard(pool.mutex);
+            if (pool.free_lists[index] != nullptr) {
+                pool.bytes -= ClassSize(index);
+                ++pool.stats.hits;
+                return PopBlock(pool.free_lists[index]);
+            }
+            if (cache == nullptr) {
+                ++pool.stats.misses;
+            }
+        }
+        if (cache != nullptr) {
+            cache->misses.fetch_add(1, std::memory_order_relaxed);
+        }
+        return ::operator new(ClassSize(index));
+    }
+
+    // Возвращает буфер в кэш потока, а при его переполнении — в общий пул
+    static void Deallocate(void *ptr, size_t bytes) noexcept {
+        const size_t index = ClassIndex(bytes);
+        if (index == kClassCount) {
+            ::operator delete(ptr);
+            return;
+        }
+
+        const size_t class_size = ClassSize(index);
+        ThreadCache *cache = GetThreadCache();
+        if (cache != nullptr &&
+            cache->bytes + class_size <= GetGlobalPool().thread_limit.load(std::memory_order_relaxed)) {
+            cache->bytes += class_size;
+            PushBlock(cache->free_lists[index], ptr);
+            return;
+        }
+        PushToGlobalPool(ptr, index);
+    }
+
+    // Возвращает суммарную статистику всех потоков
+    [[nodiscard]] static BufferCacheStats GetStats() {
+        GlobalPool &pool = GetGlobalPool();
+        std::lock_guard guard(pool.mutex);
+        BufferCacheStats stats = pool.stats;
+        for (const ThreadCache *cache = pool.thread_caches; cache != nullptr; cache = cache->next) {
+            stats.hits += cache->hits.load(std::memory_order_relaxed);
+            stats.misses += cache->misses.load(std::memory_order_relaxed);
+        }
+        return stats;
+    }
+
+    static void ResetStats() {
+        GlobalPool &pool = GetGlobalPool();
+        std::lock_guard guard(pool.mutex);
+        pool.stats = BufferCacheStats();
+        for (ThreadCache *cache = pool.thread_caches; cache != nullptr; cache = cache->next) {
+            cache->hits.store(0, std::memory_order_relaxed);
+            cache->misses.store(0, std::memory_order_relaxed);
+        }
+    }
+
+    // Освобождает буферы из кэша текущего потока и из общего пула
+    static void Trim() {
+        if (ThreadCache *cache = GetThreadCache()) {
+            for (auto &head: cache->free_lists) {
+                FreeList(head);
+            }
+            cache->bytes = 0;
+        }
+        GlobalPool &pool = GetGlobalPool();
+        std::lock_guard guard(pool.mutex);
+        for (auto &head: pool.free_lists) {
+            FreeList(head);
+        }
+        pool.bytes = 0;
+    }
+
+private:
+    // Свободные буферы одного класса связаны в список через их первые байты
+    struct FreeBlock {
+        FreeBlock *next;
+    };
+
+    struct ThreadCache {
+        ThreadCache() {
+            GlobalPool &pool = GetGlobalPool();
+            std::lock_guard guard(pool.mutex);
+            next = std::exchange(pool.thread_caches, this);
+            if (next != nullptr) {
+                next->prev = this;
+            }
+        }
+
+        // При завершении потока буферы и статистика передаются в общий пул
+        ~ThreadCache() {
+            thread_cache_destroyed = true;
+            for (size_t index = 0; index < kClassCount; ++index) {
+                while (free_lists[index] != nullptr) {
+                    PushToGlobalPool(PopBlock(free_lists[index]), index);
+                }
+            }
+
+            GlobalPool &pool = GetGlobalPool();
+            std::lock_guard guard(pool.mutex);
+            pool.stats.hits += hits.load(std::memory_order_relaxed);
+            pool.stats.misses += misses.load(std::memory_order_relaxed);
+            (prev != nullptr ? prev->next : pool.thread_caches) = next;
+            if (next != nullptr) {
+                next->prev = prev;
+            }
+        }
+
+        FreeBlock *free_lists[kClassCount] = {};
+        size_t bytes = 0;
+        // Счётчики изменяет только поток-владелец, а читает GetStats
+        std::atomic<size_t> hits = 0;
+        std::atomic<size_t> misses = 0;
+
+        // Соседи в списке кэшей всех живых потоков
+        ThreadCache *prev = nullptr;
+        ThreadCache *next = nullptr;
+    };
+
+    struct GlobalPool {
+        std::atomic<bool> enabled = false;
+        std::atomic<size_t> thread_limit = kDefaultThreadCacheLimit;
+
+        std::mutex mutex;
+        FreeBlock *free_lists[kClassCount] = {};
+        size_t bytes = 0;
+        size_t limit = kDefaultGlobalPoolLimit;
+        // Статистика общего пула и завершившихся потоков
+        BufferCacheStats stats;
+        ThreadCache *thread_caches = nullptr;
+    };
+
+    // Пул намеренно не разрушается, так как буферы могут освобождаться
+    // деструкторами статических объектов после завершения main
+    static GlobalPool &GetGlobalPool() {
+        static auto *pool = new GlobalPool;
+        return *pool;
+    }
+
+    // Возвращает кэш текущего потока либо nullptr, если поток уже завершается
+    static ThreadCache *GetThreadCache() {
+        if (thread_cache_destroyed) {
+            return nullptr;
+        }
+        thread_local ThreadCache cache;
+        return &cache;
+    }
+
+    static void PushToGlobalPool(void *ptr, size_t index) noexcept {
+        const size_t class_size = ClassSize(index);
+        GlobalPool &pool = GetGlobalPool();
+        {
+            std::lock_guard guard(pool.mutex);
+            if (pool.bytes + class_size <= pool.limit) {
+                pool.bytes += class_size;
+                PushBlock(pool.free_lists[index], ptr);
+                return;
+            }
+            ++pool.stats.evictions;
+        }
+        ::operator delete(ptr);
+    }
+
+    // Возвращает индекс наименьшего класса, вмещающего bytes байт, либо kClassCount,
+    // если буфер слишком велик для кэширования
+    static size_t ClassIndex(size_t bytes) noexcept {
+        size_t shift = kMinClassShift;
+        while (shift <= kMaxClassShift && (size_t(1) << shift) < bytes) {
+            ++shift;
+        }
+        return shift - kMinClassShift;
+    }
+
+    static size_t ClassSize(size_t index) noexcept {
+        return size_t(1) << (index + kMinClassShift);
+    }
+
+    static void PushBlock(FreeBlock *&head, void *ptr) noexcept {
+        head = ::new(ptr) FreeBlock{head};
+    }
+
+    static void *PopBlock(FreeBlock *&head) noexcept {
+        FreeBlock *block = head;
+        head = block->next;
+        return block;
+    }
+
+    static void FreeList(FreeBlock *&head) noexcept {
+        while (head != nullptr) {
+            ::operator delete(PopBlock(head));
+        }
+    }
+
+    static inline thread_local bool thread_cache_destroyed = false;
+};
@@ -1,9 +1,19 @@
 #include "simple_vector.h"
+#include "slot_map.h"
+#include "vector_io.h"
+#include "buffer_cache.h"
+#include "ring_buffer.h"
+#include "sort.h"
 
 #include <cassert>
+#include <cstdio>
+#include <fcntl.h>
 #include <iostream>
+#include <memory>
 #include <numeric>
+#include <random>
 #include <string>
+#include <thread>
 #include <stdexcept>
 
 using namespace std;
@@ -375,6 +385,577 @@ void TestNoncopiableErase() {
     cout << "Done!"s << endl << endl;
 }
 
+void TestRadixSort() {
+    cout << "Test radix sort"s << endl;
+
+    // Целые числа со знаком
+    {
+        SimpleVector<int> v{5, -3, 0, 42, -100, 7, 7, 1};
+        RadixSort(v);
+        assert((v == SimpleVector<int>{-100, -3, 0, 1, 5, 7, 7, 42}));
+    }
+
+    // Числа с плавающей точкой
+    {
+        SimpleVector<double> v{2.5, -0.5, 0.0, -7.25, 1e10, -1e-10};
+        RadixSort(v);
+        assert((v == SimpleVector<double>{-7.25, -0.5, -1e-10, 0.0, 2.5, 1e10}));
+    }
+
+    // Сортировка по ключу сохраняет порядок равных элементов
+    {
+        SimpleVector<pair<uint16_t, int>> v{{3, 0}, {1, 1}, {3, 2}, {0, 3}, {1, 4}};
+        RadixSort(v, [](const pair<uint16_t, int> &item) { return item.first; });
+        assert((v == SimpleVector<pair<uint16_t, int>>{{0, 3}, {1, 1}, {1, 4}, {3, 0}, {3, 2}}));
+    }
+
+    // Переиспользование буфера и совпадение результата с std::sort
+    {
+        mt19937_64 gen(42);
+        SimpleVector<int64_t> buffer;
+        for (size_t size: {0u, 1u, 1000u, 100000u}) {
+            SimpleVector<int64_t> v(size);
+            for (auto &item: v) {
+                item = static_cast<int64_t>(gen());
+            }
+            auto expected(v);
+            sort(expected.begin(), expected.end());
+            RadixSort(v, buffer);
+            assert(v == expected);
+        }
+    }
+    cout << "Done!"s << endl << endl;
+}
+
+void TestParallelSort() {
+    cout << "Test parallel sort"s << endl;
+    const size_t size = 1000000;
+    mt19937 gen(42);
+
+    for (size_t threads: {1u, 2u, 3u, 8u}) {
+        SimpleVector<uint32_t> v(size);
+        for (auto &item: v) {
+            item = gen();
+        }
+        auto expected(v);
+        sort(expected.begin(), expected.end(), greater<>());
+        ParallelSort(v, greater<>(), threads);
+        assert(v == expected);
+    }
+
+    // Стабильная сортировка сохраняет порядок равных элементов
+    {
+        SimpleVector<pair<int, size_t>> v(size);
+        for (size_t i = 0; i < size; ++i) {
+            v[i] = {static_cast<int>(gen() % 100), i};
+        }
+        auto expected(v);
+        auto by_key = [](const pair<int, size_t> &lhs, const pair<int, size_t> &rhs) {
+            return lhs.first < rhs.first;
+        };
+        stable_sort(expected.begin(), expected.end(), by_key);
+        SimpleVector<pair<int, size_t>> buffer;
+        ParallelStableSort(v, buffer, by_key, 5);
+        assert(v == expected);
+    }
+
+    // Компаратор, принимающий аргументы по значению, не должен опустошать элементы
+    {
+        SimpleVector<string> v(100000);
+        for (auto &item: v) {
+            item = to_string(gen());
+        }
+        auto expected(v);
+        sort(expected.begin(), expected.end());
+        ParallelStableSort(v, [](string lhs, string rhs) { return lhs < rhs; }, 4);
+        assert(v == expected);
+    }
+    cout << "Done!"s << endl << endl;
+}
+
+template<typename Queue>
+void TestQueueBasics() {
+    Queue queue(5);
+    assert(queue.GetCapacity() == 8);
+    assert(queue.GetSize() == 0);
+
+    int item = 0;
+    assert(!queue.TryPop(item));
+    for (int i = 0; i < 8; ++i) {
+        assert(queue.TryPush(i));
+    }
+    assert(!queue.TryPush(8));
+    assert(queue.GetSize() == 8);
+    assert(queue.TryPop(item) && item == 0);
+    assert(queue.TryPop(item) && item == 1);
+
+    // Пакетные операции проходят через границу кольцевого буфера
+    SimpleVector<int> items{10, 11, 12, 13};
+    assert(queue.TryPushN(items) == 2);
+    SimpleVector<int> out{-1};
+    assert(queue.TryPopN(out, 100) == 8);
+    assert((out == SimpleVector<int>{-1, 2, 3, 4, 5, 6, 7, 10, 11}));
+    assert(queue.TryPopN(out, 100) == 0);
+    assert(queue.TryPushN(items) == 4);
+    assert(queue.TryPopN(out, 3) == 3);
+    assert(out.GetSize() == 12 && out[11] == 12);
+
+    // Вместимость out при серии пакетных извлечений растёт геометрически
+    {
+        SimpleVector<int> batch{1, 2, 3, 4};
+        SimpleVector<int> all;
+        size_t reallocations = 0;
+        for (size_t i = 0; i < 1000; ++i) {
+            assert(queue.TryPushN(batch) == 4);
+            const int *old_begin = all.begin();
+            assert(queue.TryPopN(all, 4) == 4);
+            reallocations += all.begin() != old_begin;
+        }
+        assert(all.GetSize() == 4000);
+        assert(reallocations < 20);
+    }
+}
+
+template<typename Queue>
+void TestQueueThreads(size_t producers, size_t consumers) {
+    const size_t count = 100000;
+    Queue queue(64);
+    std::atomic<size_t> popped = 0;
+    std::atomic<uint64_t> sum = 0;
+
+    SimpleVector<thread> threads;
+    for (size_t p = 0; p < producers; ++p) {
+        threads.PushBack(thread([&, p] {
+            SimpleVector<uint64_t> batch;
+            for (size_t i = p; i < count; i += producers) {
+                batch.PushBack(i);
+                if (batch.GetSize() == 7 || i + producers >= count) {
+                    const uint64_t *first = batch.begin();
+                    while (first != batch.end()) {
+                        const size_t pushed = queue.TryPushN(first, batch.end());
+                        if (pushed == 0) this_thread::yield();
+                        first += pushed;
+                    }
+                    batch.Clear();
+                }
+            }
+        }));
+    }
+    for (size_t c = 0; c < consumers; ++c) {
+        threads.PushBack(thread([&] {
+            SimpleVector<uint64_t> out;
+            while (popped.load() < count) {
+                out.Clear();
+                const size_t n = queue.TryPopN(out, 5);
+                for (auto item: out) {
+                    sum += item;
+                }
+                if (n == 0) this_thread::yield();
+                popped += n;
+            }
+        }));
+    }
+    for (auto &t: threads) {
+        t.join();
+    }
+    assert(popped == count);
+    assert(sum == uint64_t(count) * (count - 1) / 2);
+}
+
+class ThrowingDefault {
+public:
+    inline static bool throw_on_default = false;
+
+    ThrowingDefault() {
+        if (throw_on_default) throw runtime_error("default constructor");
+    }
+
+    ThrowingDefault(int value) : value_(value) {
+    }
+
+    int GetValue() const {
+        return value_;
+    }
+
+private:
+    int value_ = 0;
+};
+
+void TestMpmcPopNException() {
+    MpmcQueue<ThrowingDefault> queue(4);
+    assert(queue.TryPush(ThrowingDefault(1)));
+    assert(queue.TryPush(ThrowingDefault(2)));
+
+    SimpleVector<ThrowingDefault> out;
+    ThrowingDefault::throw_on_default = true;
+    try {
+        queue.TryPopN(out, 2);
+        assert(false);
+    } catch (const runtime_error &) {
+    }
+    ThrowingDefault::throw_on_default = false;
+
+    // Неудачный вызов не захватывает ячейки, и очередь продолжает работать
+    assert(queue.GetSize() == 2);
+    assert(queue.TryPopN(out, 2) == 2);
+    assert(out[0].GetValue() == 1 && out[1].GetValue() == 2);
+    assert(queue.TryPush(ThrowingDefault(3)));
+    ThrowingDefault item;
+    assert(queue.TryPop(item) && item.GetValue() == 3);
+}
+
+class ThrowingCopy {
+public:
+    inline static bool throw_on_copy = false;
+
+    ThrowingCopy() = default;
+
+    ThrowingCopy(int value) : value_(value) {
+    }
+
+    ThrowingCopy(const ThrowingCopy &other) : value_(other.value_) {
+        if (throw_on_copy) throw runtime_error("copy constructor");
+    }
+
+    ThrowingCopy &operator=(const ThrowingCopy &other) {
+        if (throw_on_copy) throw runtime_error("copy assignment");
+        value_ = other.value_;
+        return *this;
+    }
+
+    ThrowingCopy(ThrowingCopy &&other) noexcept = default;
+
+    ThrowingCopy &operator=(ThrowingCopy &&other) noexcept = default;
+
+    int GetValue() const {
+        return value_;
+    }
+
+private:
+    int value_ = 0;
+};
+
+void TestMpmcPushNException() {
+    MpmcQueue<ThrowingCopy> queue(4);
+    SimpleVector<ThrowingCopy> items;
+    items.PushBack(ThrowingCopy(1));
+    items.PushBack(ThrowingCopy(2));
+    items.PushBack(ThrowingCopy(3));
+    const ThrowingCopy single(4);
+
+    ThrowingCopy::throw_on_copy = true;
+    try {
+        queue.TryPushN(items);
+        assert(false);
+    } catch (const runtime_error &) {
+    }
+    try {
+        queue.TryPush(single);
+        assert(false);
+    } catch (const runtime_error &) {
+    }
+    ThrowingCopy::throw_on_copy = false;
+
+    // Неудачные вызовы не захватывают ячейки, и очередь продолжает работать
+    assert(queue.GetSize() == 0);
+    assert(queue.TryPushN(items) == 3);
+    assert(queue.TryPush(single));
+    SimpleVector<ThrowingCopy> out;
+    assert(queue.TryPopN(out, 4) == 4);
+    assert(out[0].GetValue() == 1 && out[2].GetValue() == 3 && out[3].GetValue() == 4);
+}
+
+void TestRingBuffer() {
+    cout << "Test ring buffer"s << endl;
+    TestQueueBasics<SpscQueue<int>>();
+    TestQueueBasics<MpmcQueue<int>>();
+    TestMpmcPopNException();
+    TestMpmcPushNException();
+    TestQueueThreads<SpscQueue<uint64_t>>(1, 1);
+    TestQueueThreads<MpmcQueue<uint64_t>>(1, 1);
+    TestQueueThreads<MpmcQueue<uint64_t>>(4, 3);
+    cout << "Done!"s << endl << endl;
+}
+
+void TestBufferCache() {
+    cout << "Test buffer cache"s << endl;
+    BufferCache::Enable();
+    BufferCache::ResetStats();
+
+    // Буфер уничтоженного вектора переиспользуется при следующем Reserve того же класса размеров
+    {
+        const int *old_data;
+        {
+            SimpleVector<int> v(100, 1);
+            old_data = v.begin();
+        }
+        SimpleVector<int> v;
+        v.Reserve(120);
+        assert(v.begin() == old_data);
+        const auto stats = BufferCache::GetStats();
+        assert(stats.hits == 1);
+        assert(stats.misses == 1);
+    }
+
+    // Освобождённые буферы, не помещающиеся в кэш потока и общий пул, вытесняются
+    {
+        BufferCache::SetThreadCacheLimit(0);
+        BufferCache::SetGlobalPoolLimit(1024);
+        BufferCache::Trim();
+        BufferCache::ResetStats();
+        {
+            SimpleVector<int> v1(200);
+            SimpleVector<int> v2(200);
+        }
+        assert(BufferCache::GetStats().evictions == 1);
+        BufferCache::SetThreadCacheLimit(BufferCache::kDefaultThreadCacheLimit);
+        BufferCache::SetGlobalPoolLimit(BufferCache::kDefaultGlobalPoolLimit);
+    }
+
+    // Слишком большой размер массива не должен переполнять размер буфера в байтах
+    try {
+        ArrayPtr<int> ptr(SIZE_MAX / sizeof(int) + 2);
+        assert(false);
+    } catch (const bad_array_new_length &) {
+    }
+
+    // Release возвращает массив, который можно освободить через delete[]
+    {
+        ArrayPtr<string> ptr(3);
+        ptr[2] = "hello"s;
+        string *raw = ptr.Release();
+        assert(!ptr);
+        assert(raw[2] == "hello"s);
+        delete[] raw;
+    }
+
+    // Создание и уничтожение векторов в нескольких потоках
+    {
+        BufferCache::ResetStats();
+        SimpleVector<thread> threads;
+        for (size_t t = 0; t < 4; ++t) {
+            threads.PushBack(thread([] {
+                for (size_t i = 0; i < 1000; ++i) {
+                    SimpleVector<string> v;
+                    for (size_t j = 0; j < i % 50; ++j) {
+                        v.PushBack(to_string(j));
+                    }
+                }
+            }));
+        }
+        for (auto &t: threads) {
+            t.join();
+        }
+        const auto stats = BufferCache::GetStats();
+        assert(stats.hits > stats.misses);
+    }
+
+    BufferCache::Enable(false);
+    BufferCache::Trim();
+    cout << "Done!"s << endl << endl;
+}
+
+void TestResizeUninitialized() {
+    cout << "Test resize uninitialized"s << endl;
+    {
+        SimpleVector<char> v{'a', 'b'};
+        v.ResizeUninitialized(10);
+        assert(v.GetSize() == 10);
+        assert(v.GetCapacity() >= 10);
+        assert(v[0] == 'a' && v[1] == 'b');
+        const auto old_begin = v.begin();
+        v.ResizeUninitialized(4);
+        assert(v.GetSize() == 4);
+        assert(v.begin() == old_begin);
+    }
+    {
+        SimpleVector<string> v{"a"s};
+        v.PushBack("b"s);
+        v.PopBack();
+        v.ResizeDefaultInit(3);
+        assert((v == SimpleVector<string>{"a"s, ""s, ""s}));
+    }
+    cout << "Done!"s << endl << endl;
+}
+
+void TestVectorIo() {
+    cout << "Test vector I/O"s << endl;
+    const size_t size = 200000;
+    SimpleVector<uint8_t> data(size);
+    for (size_t i = 0; i < size; ++i) {
+        data[i] = static_cast<uint8_t>(i * 7);
+    }
+
+    FILE *file = tmpfile();
+    assert(file != nullptr);
+    const int fd = fileno(file);
+    assert(WriteAll(fd, data) == size);
+
+    // Чтение до конца файла
+    {
+        assert(lseek(fd, 0, SEEK_SET) == 0);
+        SimpleVector<uint8_t> v;
+        assert(ReadAppend(fd, v).bytes == size);
+        assert(v == data);
+    }
+
+    // Чтение ограниченного количества байт в конец непустого вектора
+    {
+        assert(lseek(fd, 0, SEEK_SET) == 0);
+        SimpleVector<uint8_t> v{1, 2, 3};
+        const auto result = ReadAppend(fd, v, 1000);
+        assert(result.bytes == 1000 && !result.eof);
+        assert(v.GetSize() == 1003);
+        assert(equal(data.begin(), data.begin() + 1000, v.begin() + 3));
+    }
+
+    // Чтение через readv, в том числе когда данные не помещаются в свободную часть вектора
+    {
+        assert(lseek(fd, 0, SEEK_SET) == 0);
+        SimpleVector<uint8_t> v;
+        v.Reserve(100);
+        const auto result = ReadvAppend(fd, v);
+        assert(result.bytes == size && result.eof);
+        assert(v == data);
+    }
+    {
+        assert(lseek(fd, 0, SEEK_SET) == 0);
+        SimpleVector<uint8_t> v;
+        assert(ReadvAppend(fd, v, 70000).bytes == 70000);
+        assert(equal(data.begin(), data.begin() + 70000, v.begin()));
+        assert(ReadvAppend(fd, v).bytes == size - 70000);
+        assert(v == data);
+    }
+
+    // Неблокирующий канал: отсутствие данных отличается от закрытия записывающей стороны
+    for (auto read_append: {&ReadAppend<char>, &ReadvAppend<char>}) {
+        int fds[2];
+        assert(pipe(fds) == 0);
+        assert(fcntl(fds[0], F_SETFL, O_NONBLOCK) == 0);
+        assert(fcntl(fds[1], F_SETFL, O_NONBLOCK) == 0);
+        SimpleVector<char> v;
+
+        // Запись в заполненный канал останавливается на EAGAIN и сообщает, сколько байт записано
+        {
+            SimpleVector<char> big(1 << 20, 'x');
+            const size_t written = WriteAll(fds[1], big);
+            assert(written > 0 && written < big.GetSize());
+            const auto result = read_append(fds[0], v, SIZE_MAX);
+            assert(result.bytes == written && !result.eof);
+            assert(all_of(v.begin(), v.end(), [](char c) { return c == 'x'; }));
+            v.Clear();
+        }
+
+        auto result = read_append(fds[0], v, SIZE_MAX);
+        assert(result.bytes == 0 && !result.eof);
+
+        assert(WriteAll(fds[1], SimpleVector<char>{'a', 'b', 'c'}) == 3);
+        result = read_append(fds[0], v, SIZE_MAX);
+        assert(result.bytes == 3 && !result.eof);
+
+        assert(WriteAll(fds[1], SimpleVector<char>{'d'}) == 1);
+        close(fds[1]);
+        result = read_append(fds[0], v, SIZE_MAX);
+        assert(result.bytes == 1 && result.eof);
+        assert((v == SimpleVector<char>{'a', 'b', 'c', 'd'}));
+        close(fds[0]);
+    }
+
+    // Ошибки чтения превращаются в исключения
+    try {
+        SimpleVector<char> v;
+        ReadAppend(-1, v);
+        assert(false);
+    } catch (const system_error &) {
+    }
+    fclose(file);
+    cout << "Done!"s << endl << endl;
+}
+
+void TestSlotMap() {
+    cout << "Test slot map"s << endl;
+    SlotMap<string> map;
+    assert(map.IsEmpty());
+    assert(!map.Contains(SlotMap<string>::Handle()));
+
+    const auto a = map.Insert("a"s);
+    const auto b = map.Insert("b"s);
+    const auto c = map.Insert("c"s);
+    assert(map.GetSize() == 3);
+    assert(map[a] == "a"s && map.At(b) == "b"s && *map.Find(c) == "c"s);
+
+    // Удаление переносит последний элемент на место удалённого, не затрагивая дескрипторы
+    assert(map.Erase(a));
+    assert(!map.Erase(a));
+    assert(map.GetSize() == 2);
+    assert(!map.Contains(a));
+    assert(map.Find(a) == nullptr);
+    assert(map[b] == "b"s && map[c] == "c"s);
+    assert(*map.begin() == "c"s);
+    assert(map.GetHandle(0) == c);
+    try {
+        map.At(a);
+        assert(false);
+    } catch (const out_of_range &) {
+    }
+
+    // Освободившийся слот переиспользуется с новым поколением
+    const auto d = map.Insert("d"s);
+    assert(d.index == a.index);
+    assert(d != a);
+    assert(!map.Contains(a));
+    assert(map[d] == "d"s);
+
+    // Большое количество вставок и удалений
+    {
+        SlotMap<size_t> numbers;
+        SimpleVector<SlotMap<size_t>::Handle> handles;
+        for (size_t i = 0; i < 1000; ++i) {
+            handles.PushBack(numbers.Insert(i));
+        }
+        for (size_t i = 0; i < 1000; i += 3) {
+            assert(numbers.Erase(handles[i]));
+        }
+        size_t sum = 0;
+        for (size_t value: numbers) {
+            sum += value;
+        }
+        for (size_t i = 0; i < 1000; ++i) {
+            assert(numbers.Contains(handles[i]) == (i % 3 != 0));
+            if (i % 3 != 0) {
+                assert(numbers[handles[i]] == i);
+                sum -= i;
+            }
+        }
+        assert(sum == 0);
+    }
+
+    // Удалённые элементы освобождают свои ресурсы
+    {
+        auto resource = make_shared<int>(42);
+        SlotMap<shared_ptr<int>> pointers;
+        const auto first = pointers.Insert(resource);
+        const auto second = pointers.Insert(resource);
+        assert(resource.use_count() == 3);
+        assert(pointers.Erase(second));
+        assert(resource.use_count() == 2);
+        assert(pointers.Erase(first));
+        assert(resource.use_count() == 1);
+
+        pointers.Insert(resource);
+        pointers.Insert(resource);
+        pointers.Clear();
+        assert(resource.use_count() == 1);
+    }
+
+    map.Clear();
+    assert(map.IsEmpty());
+    assert(!map.Contains(b) && !map.Contains(c) && !map.Contains(d));
+    const auto e = map.Insert("e"s);
+    assert(map.GetSize() == 1 && map[e] == "e"s);
+    cout << "Done!"s << endl << endl;
+}
+
 int main() {
     TestBasicMethods();
     TestTemporaryObjConstructor();
@@ -385,5 +966,12 @@ int main() {
     TestNoncopiablePushBack();
     TestNoncopiableInsert();
     TestNoncopiableErase();
+    TestRadixSort();
+    TestParallelSort();
+    TestRingBuffer();
+    TestBufferCache();
+    TestResizeUninitialized();
+    TestVectorIo();
+    TestSlotMap();
     return 0;
 }
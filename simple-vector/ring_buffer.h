@@ -0,0 +1,341 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include "array_ptr.h"
+#include "simple_vector.h"
+
+namespace ring_buffer_detail {
+
+    // Размер кэш-линии. Индексы, которые изменяют разные потоки, разносятся по разным линиям
+    constexpr size_t kCacheLineSize = 64;
+
+    // Округляет capacity вверх до степени двойки
+    inline size_t RoundUpToPowerOfTwo(size_t capacity) {
+        if (capacity == 0) throw std::invalid_argument("Capacity must be positive.");
+        size_t result = 1;
+        while (result < capacity) {
+            if (result > SIZE_MAX / 2) throw std::length_error("Capacity is too large.");
+            result *= 2;
+        }
+        return result;
+    }
+
+    // Гарантирует место ещё для count элементов в конце out.
+    // Вместимость растёт как минимум вдвое, чтобы серия пакетных извлечений не копировала out каждый раз
+    template<typename Type>
+    void ReserveForAppend(SimpleVector<Type> &out, size_t count) {
+        const size_t required = out.GetSize() + count;
+        if (required > out.GetCapacity()) {
+            out.Reserve(std::max(required, out.GetCapacity() * 2));
+        }
+    }
+
+} // namespace ring_buffer_detail
+
+// Ограниченная очередь для одного производителя и одного потребителя.
+// Все операции не ждут другой поток и завершаются за конечное число шагов
+template<typename Type>
+class SpscQueue {
+public:
+    // Создаёт очередь вместимостью capacity, округлённой вверх до степени двойки
+    explicit SpscQueue(size_t capacity)
+            : capacity_(ring_buffer_detail::RoundUpToPowerOfTwo(capacity)),
+              mask_(capacity_ - 1),
+              data_(capacity_) {
+    }
+
+    SpscQueue(const SpscQueue &) = delete;
+
+    SpscQueue &operator=(const SpscQueue &) = delete;
+
+    // Добавляет элемент в конец очереди. Возвращает false, если очередь заполнена.
+    // Вызывается только потоком-производителем
+    bool TryPush(const Type &item) {
+        return TryEmplace(item);
+    }
+
+    bool TryPush(Type &&item) {
+        return TryEmplace(std::move(item));
+    }
+
+    // Извлекает элемент из начала очереди в item. Возвращает false, если очередь пуста.
+    // Вызывается только потоком-потребителем
+    bool TryPop(Type &item) {
+        const size_t head = head_.load(std::memory_order_relaxed);
+        if (head == cached_tail_) {
+            cached_tail_ = tail_.load(std::memory_order_acquire);
+            if (head == cached_tail_) return false;
+        }
+        item = std::move(data_[head & mask_]);
+        head_.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Копирует в очередь столько элементов из [first, last), сколько в ней помещается.
+    // Возвращает количество добавленных элементов
+    size_t TryPushN(const Type *first, const Type *last) {
+        const size_t tail = tail_.load(std::memory_order_relaxed);
+        const size_t wanted = last - first;
+        if (capacity_ - (tail - cached_head_) < wanted) {
+            cached_head_ = head_.load(std::memory_order_acquire);
+        }
+        const size_t count = std::min(wanted, capacity_ - (tail - cached_head_));
+        if (count == 0) return 0;
+
+        // Диапазон в кольцевом буфере может состоять из двух непрерывных частей
+        const size_t offset = tail & mask_;
+        const size_t first_part = std::min(count, capacity_ - offset);
+        std::copy(first, first + first_part, data_.Get() + offset);
+        std::copy(first + first_part, first + count, data_.Get());
+        tail_.store(tail + count, std::memory_order_release);
+        return count;
+    }
+
+    size_t TryPushN(const SimpleVector<Type> &items) {
+        return TryPushN(items.begin(), items.end());
+    }
+
+    // Перемещает из очереди в конец out не более max_count элементов.
+    // Возвращает количество извлечённых элементов
+    size_t TryPopN(SimpleVector<Type> &out, size_t max_count) {
+        const size_t head = head_.load(std::memory_order_relaxed);
+        if (cached_tail_ - head < max_count) {
+            cached_tail_ = tail_.load(std::memory_order_acquire);
+        }
+        const size_t count = std::min(max_count, cached_tail_ - head);
+        if (count == 0) return 0;
+
+        const size_t old_size = out.GetSize();
+        ring_buffer_detail::ReserveForAppend(out, count);
+        out.ResizeDefaultInit(old_size + count);
+        const size_t offset = head & mask_;
+        const size_t first_part = std::min(count, capacity_ - offset);
+        auto *dest = out.begin() + old_size;
+        std::move(data_.Get() + offset, data_.Get() + offset + first_part, dest);
+        std::move(data_.Get(), data_.Get() + (count - first_part), dest + first_part);
+        head_.store(head + count, std::memory_order_release);
+        return count;
+    }
+
+    // Возвращает вместимость очереди
+    [[nodiscard]] size_t GetCapacity() const noexcept {
+        return capacity_;
+    }
+
+    // Возвращает количество элементов в очереди.
+    // При одновременной работе других потоков значение может сразу устареть
+    [[nodiscard]] size_t GetSize() const noexcept {
+        const size_t head = head_.load(std::memory_order_acquire);
+        return tail_.load(std::memory_order_acquire) - head;
+    }
+
+private:
+    template<typename Item>
+    bool TryEmplace(Item &&item) {
+        const size_t tail = tail_.load(std::memory_order_relaxed);
+        if (tail - cached_head_ == capacity_) {
+            cached_head_ = head_.load(std::memory_order_acquire);
+            if (tail - cached_head_ == capacity_) return false;
+        }
+        data_[tail & mask_] = std::forward<Item>(item);
+        tail_.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+private:
+    const size_t capacity_;
+    const size_t mask_;
+    ArrayPtr<Type> data_;
+
+    // Индекс начала очереди и последний увиденный потребителем индекс конца
+    alignas(ring_buffer_detail::kCacheLineSize) std::atomic<size_t> head_ = 0;
+    size_t cached_tail_ = 0;
+
+    // Индекс конца очереди и последний увиденный производителем индекс начала
+    alignas(ring_buffer_detail::kCacheLineSize) std::atomic<size_t> tail_ = 0;
+    size_t cached_head_ = 0;
+
+    char padding_[ring_buffer_detail::kCacheLineSize - sizeof(std::atomic<size_t>) - sizeof(size_t)] = {};
+};
+
+// Ограниченная очередь для нескольких производителей и нескольких потребителей (алгоритм Вьюкова).
+// Каждая ячейка хранит номер круга, по которому потоки определяют, свободна она или заполнена
+template<typename Type>
+class MpmcQueue {
+public:
+    // Создаёт очередь вместимостью capacity, округлённой вверх до степени двойки
+    explicit MpmcQueue(size_t capacity)
+            : capacity_(ring_buffer_detail::RoundUpToPowerOfTwo(capacity)),
+              mask_(capacity_ - 1),
+              cells_(capacity_) {
+        for (size_t i = 0; i < capacity_; ++i) {
+            cells_[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    MpmcQueue(const MpmcQueue &) = delete;
+
+    MpmcQueue &operator=(const MpmcQueue &) = delete;
+
+    // Добавляет элемент в конец очереди. Возвращает false, если очередь заполнена
+    bool TryPush(const Type &item) {
+        return TryEmplace(item);
+    }
+
+    bool TryPush(Type &&item) {
+        return TryEmplace(std::move(item));
+    }
+
+    // Извлекает элемент из начала очереди в item. Возвращает false, если очередь пуста
+    bool TryPop(Type &item) {
+        size_t pos = dequeue_pos_.load(std::memory_order_relaxed);
+        const size_t count = Claim(dequeue_pos_, pos, 1, 1);
+        if (count == 0) return false;
+        Cell &cell = cells_[pos & mask_];
+        item = std::move(cell.value);
+        cell.sequence.store(pos + capacity_, std::memory_order_release);
+        return true;
+    }
+
+    // Копирует в очередь столько элементов из [first, last), сколько удаётся занять подряд
+    // идущих свободных ячеек. Возвращает количество добавленных элементов
+    size_t TryPushN(const Type *first, const Type *last) {
+        if constexpr (std::is_nothrow_copy_assignable_v<Type>) {
+            size_t pos = enqueue_pos_.load(std::memory_order_relaxed);
+            const size_t count = Claim(enqueue_pos_, pos, last - first, 0);
+            for (size_t i = 0; i < count; ++i) {
+                Cell &cell = cells_[(pos + i) & mask_];
+                cell.value = first[i];
+                cell.sequence.store(pos + i + 1, std::memory_order_release);
+            }
+            return count;
+        } else {
+            // Копирование может выбросить исключение, поэтому элементы копируются до захвата ячеек,
+            // а в ячейки затем только перемещаются
+            const size_t wanted = std::min(static_cast<size_t>(last - first), capacity_);
+            SimpleVector<Type> copies(::Reserve(wanted));
+            for (size_t i = 0; i < wanted; ++i) {
+                copies.PushBack(first[i]);
+            }
+
+            size_t pos = enqueue_pos_.load(std::memory_order_relaxed);
+            const size_t count = Claim(enqueue_pos_, pos, wanted, 0);
+            for (size_t i = 0; i < count; ++i) {
+                Cell &cell = cells_[(pos + i) & mask_];
+                cell.value = std::move(copies[i]);
+                cell.sequence.store(pos + i + 1, std::memory_order_release);
+            }
+            return count;
+        }
+    }
+
+    size_t TryPushN(const SimpleVector<Type> &items) {
+        return TryPushN(items.begin(), items.end());
+    }
+
+    // Перемещает из очереди в конец out не более max_count элементов.
+    // Возвращает количество извлечённых элементов
+    size_t TryPopN(SimpleVector<Type> &out, size_t max_count) {
+        // Память резервируется до захвата ячеек: после захвата ничто не должно помешать
+        // освободить их, иначе очередь навсегда остановится на этих ячейках
+        max_count = std::min(max_count, capacity_);
+        ring_buffer_detail::ReserveForAppend(out, max_count);
+
+        size_t pos = dequeue_pos_.load(std::memory_order_relaxed);
+        const size_t count = Claim(dequeue_pos_, pos, max_count, 1);
+        size_t i = 0;
+        try {
+            for (; i < count; ++i) {
+                Cell &cell = cells_[(pos + i) & mask_];
+                out.PushBack(std::move(cell.value));
+                cell.sequence.store(pos + i + capacity_, std::memory_order_release);
+            }
+        } catch (...) {
+            // Если перемещение элемента выбросило исключение, оставшиеся ячейки всё равно освобождаются
+            for (; i < count; ++i) {
+                cells_[(pos + i) & mask_].sequence.store(pos + i + capacity_, std::memory_order_release);
+            }
+            throw;
+        }
+        return count;
+    }
+
+    // Возвращает вместимость очереди
+    [[nodiscard]] size_t GetCapacity() const noexcept {
+        return capacity_;
+    }
+
+    // Возвращает приблизительное количество элементов в очереди
+    [[nodiscard]] size_t GetSize() const noexcept {
+        const size_t dequeue_pos = dequeue_pos_.load(std::memory_order_acquire);
+        const size_t enqueue_pos = enqueue_pos_.load(std::memory_order_acquire);
+        return enqueue_pos > dequeue_pos ? enqueue_pos - dequeue_pos : 0;
+    }
+
+private:
+    // После захвата ячейки элемент в неё перемещается, и это перемещение не должно прерываться исключением
+    static_assert(std::is_nothrow_move_assignable_v<Type>, "MpmcQueue requires a nothrow move assignment");
+
+    struct Cell {
+        std::atomic<size_t> sequence;
+        Type value;
+    };
+
+    template<typename Item>
+    bool TryEmplace(Item &&item) {
+        if constexpr (std::is_nothrow_assignable_v<Type &, Item &&>) {
+            size_t pos = enqueue_pos_.load(std::memory_order_relaxed);
+            if (Claim(enqueue_pos_, pos, 1, 0) == 0) return false;
+            Cell &cell = cells_[pos & mask_];
+            cell.value = std::forward<Item>(item);
+            cell.sequence.store(pos + 1, std::memory_order_release);
+            return true;
+        } else {
+            // Захваченную ячейку нужно освободить в любом случае, поэтому копия,
+            // которая может выбросить исключение, создаётся заранее
+            Type value(std::forward<Item>(item));
+            return TryEmplace(std::move(value));
+        }
+    }
+
+    // Занимает не более max_count подряд идущих ячеек, начиная с позиции position.
+    // Ячейка с номером i готова, если её sequence равен i + lag: для производителей lag = 0,
+    // для потребителей lag = 1. Возвращает количество занятых ячеек, а в position — первую из них
+    size_t Claim(std::atomic<size_t> &position, size_t &pos, size_t max_count, size_t lag) {
+        if (max_count == 0) return 0;
+        while (true) {
+            size_t count = 0;
+            intptr_t diff = 0;
+            while (count < max_count) {
+                const size_t seq = cells_[(pos + count) & mask_].sequence.load(std::memory_order_acquire);
+                diff = static_cast<intptr_t>(seq - (pos + count + lag));
+                if (diff != 0) break;
+                ++count;
+            }
+            if (count == 0) {
+                // Очередь заполнена (для производителя) или пуста (для потребителя)
+                if (diff < 0) return 0;
+                // Ячейку уже занял другой поток: перечитываем позицию
+                pos = position.load(std::memory_order_relaxed);
+                continue;
+            }
+            if (position.compare_exchange_weak(pos, pos + count, std::memory_order_relaxed)) {
+                return count;
+            }
+        }
+    }
+
+private:
+    const size_t capacity_;
+    const size_t mask_;
+    ArrayPtr<Cell> cells_;
+
+    alignas(ring_buffer_detail::kCacheLineSize) std::atomic<size_t> enqueue_pos_ = 0;
+    alignas(ring_buffer_detail::kCacheLineSize) std::atomic<size_t> dequeue_pos_ = 0;
+    char padding_[ring_buffer_detail::kCacheLineSize - sizeof(std::atomic<size_t>)] = {};
+};
@@ -3,6 +3,7 @@
 #include <algorithm>
 #include <cassert>
 #include <stdexcept>
+#include <type_traits>
 #include "array_ptr.h"
 
 class ReserveProxyObj {
@@ -116,6 +117,27 @@ public:
         size_ = new_size;
     }
 
+    // Изменяет размер массива.
+    // При увеличении размера новые элементы инициализируются по умолчанию:
+    // элементы тривиальных типов не заполняются, остальные получают значение Type()
+    void ResizeDefaultInit(size_t new_size) {
+        if constexpr (std::is_trivial_v<Type>) {
+            ResizeUninitialized(new_size);
+        } else {
+            Resize(new_size);
+        }
+    }
+
+    // Изменяет размер массива, не заполняя новые элементы.
+    // Предназначен для тривиальных типов, элементы которых сразу будут перезаписаны
+    void ResizeUninitialized(size_t new_size) {
+        static_assert(std::is_trivial_v<Type>, "ResizeUninitialized requires a trivial type");
+        if (new_size > capacity_) {
+            Reserve(new_size);
+        }
+        size_ = new_size;
+    }
+
     void Reserve(size_t new_capacity) {
         if (new_capacity > capacity_) {
             ArrayPtr<Type> tmp(new_capacity);
@@ -0,0 +1,217 @@
+#pragma once
+
+#include <cassert>
+#include <cstdint>
+#include <stdexcept>
+#include <utility>
+#include "simple_vector.h"
+
+// Контейнер, выдающий на каждый элемент устойчивый дескриптор (handle).
+// Элементы хранятся плотно в SimpleVector, поэтому обход идёт по непрерывной памяти,
+// а вставка и удаление выполняются за O(1): удаляемый элемент заменяется последним.
+// Дескриптор ссылается на слот в разреженной таблице, которая хранит позицию элемента
+// в плотном массиве и номер поколения. При удалении номер поколения слота увеличивается,
+// поэтому дескрипторы удалённых элементов перестают быть действительными
+template<typename Type>
+class SlotMap {
+public:
+    using Iterator = Type *;
+    using ConstIterator = const Type *;
+
+    struct Handle {
+        size_t index = 0;
+        // Поколения слотов начинаются с 1, поэтому дескриптор по умолчанию недействителен
+        size_t generation = 0;
+
+        bool operator==(const Handle &other) const noexcept {
+            return index == other.index && generation == other.generation;
+        }
+
+        bool operator!=(const Handle &other) const noexcept {
+            return !(*this == other);
+        }
+    };
+
+    SlotMap() noexcept = default;
+
+    // Резервирует место под capacity элементов
+    void Reserve(size_t capacity) {
+        values_.Reserve(capacity);
+        dense_to_slot_.Reserve(capacity);
+        slots_.Reserve(capacity);
+    }
+
+    // Добавляет элемент и возвращает его дескриптор
+    Handle Insert(const Type &value) {
+        values_.PushBack(value);
+        return AttachLast();
+    }
+
+    Handle Insert(Type &&value) {
+        values_.PushBack(std::move(value));
+        return AttachLast();
+    }
+
+    // Удаляет элемент с дескриптором handle, перемещая на его место последний элемент.
+    // Возвращает false, если дескриптор недействителен
+    bool Erase(Handle handle) {
+        if (!Contains(handle)) return false;
+
+        Slot &slot = slots_[handle.index];
+        const size_t position = slot.position;
+        const size_t last = values_.GetSize() - 1;
+        if (position != last) {
+            values_[position] = std::move(values_[last]);
+            dense_to_slot_[position] = dense_to_slot_[last];
+            slots_[dense_to_slot_[position]].position = position;
+        }
+        // PopBack только уменьшает размер, поэтому освобождаем ресурсы хвостового элемента явно
+        values_[last] = Type();
+        values_.PopBack();
+        dense_to_slot_.PopBack();
+
+        ++slot.generation;
+        slot.position = free_head_;
+        free_head_ = handle.index;
+        return true;
+    }
+
+    // Сообщает, ссылается ли дескриптор на существующий элемент
+    [[nodiscard]] bool Contains(Handle handle) const noexcept {
+        return handle.index < slots_.GetSize() && slots_[handle.index].generation == handle.generation;
+    }
+
+    // Возвращает указатель на элемент либо nullptr, если дескриптор недействителен
+    Type *Find(Handle handle) noexcept {
+        return Contains(handle) ? &values_[slots_[handle.index].position] : nullptr;
+    }
+
+    const Type *Find(Handle handle) const noexcept {
+        return Contains(handle) ? &values_[slots_[handle.index].position] : nullptr;
+    }
+
+    // Возвращает ссылку на элемент с дескриптором handle.
+    // Выбрасывает исключение std::out_of_range, если дескриптор недействителен
+    Type &At(Handle handle) {
+        if (!Contains(handle)) throw std::out_of_range("Invalid slot map handle.");
+        return values_[slots_[handle.index].position];
+    }
+
+    const Type &At(Handle handle) const {
+        if (!Contains(handle)) throw std::out_of_range("Invalid slot map handle.");
+        return values_[slots_[handle.index].position];
+    }
+
+    // Возвращает ссылку на элемент с дескриптором handle. Дескриптор должен быть действителен
+    Type &operator[](Handle handle) noexcept {
+        assert(Contains(handle));
+        return values_[slots_[handle.index].position];
+    }
+
+    const Type &operator[](Handle handle) const noexcept {
+        assert(Contains(handle));
+        return values_[slots_[handle.index].position];
+    }
+
+    // Возвращает дескриптор элемента, находящегося на позиции position плотного массива
+    [[nodiscard]] Handle GetHandle(size_t position) const noexcept {
+        assert(position < values_.GetSize());
+        const size_t index = dense_to_slot_[position];
+        return Handle{index, slots_[index].generation};
+    }
+
+    // Удаляет все элементы. Все выданные дескрипторы становятся недействительными
+    void Clear() {
+        for (auto &value: values_) {
+            value = Type();
+        }
+        for (size_t index: dense_to_slot_) {
+            Slot &slot = slots_[index];
+            ++slot.generation;
+            slot.position = free_head_;
+            free_head_ = index;
+        }
+        values_.Clear();
+        dense_to_slot_.Clear();
+    }
+
+    // Возвращает количество элементов
+    [[nodiscard]] size_t GetSize() const noexcept {
+        return values_.GetSize();
+    }
+
+    // Сообщает, пуст ли контейнер
+    [[nodiscard]] bool IsEmpty() const noexcept {
+        return values_.IsEmpty();
+    }
+
+    // Итераторы обходят элементы в порядке плотного массива.
+    // Удаление элемента меняет порядок и делает итераторы недействительными
+    Iterator begin() noexcept {
+        return values_.begin();
+    }
+
+    Iterator end() noexcept {
+        return values_.end();
+    }
+
+    ConstIterator begin() const noexcept {
+        return values_.begin();
+    }
+
+    ConstIterator end() const noexcept {
+        return values_.end();
+    }
+
+    ConstIterator cbegin() const noexcept {
+        return values_.cbegin();
+    }
+
+    ConstIterator cend() const noexcept {
+        return values_.cend();
+    }
+
+private:
+    static constexpr size_t kNoSlot = SIZE_MAX;
+
+    struct Slot {
+        // Позиция элемента в values_, а для свободного слота — индекс следующего свободного слота
+        size_t position = kNoSlot;
+        size_t generation = 1;
+    };
+
+    // Связывает только что добавленный в конец values_ элемент со свободным слотом
+    Handle AttachLast() {
+        const size_t position = values_.GetSize() - 1;
+        size_t index = free_head_;
+        try {
+            dense_to_slot_.PushBack(index);
+            if (index == kNoSlot) {
+                index = slots_.GetSize();
+                slots_.PushBack(Slot());
+            }
+        } catch (...) {
+            if (dense_to_slot_.GetSize() > position) {
+                dense_to_slot_.PopBack();
+            }
+            values_.PopBack();
+            throw;
+        }
+
+        Slot &slot = slots_[index];
+        if (index == free_head_) {
+            free_head_ = slot.position;
+        }
+        slot.position = position;
+        dense_to_slot_[position] = index;
+        return Handle{index, slot.generation};
+    }
+
+private:
+    SimpleVector<Type> values_;
+    // Индекс слота для каждого элемента values_
+    SimpleVector<size_t> dense_to_slot_;
+    SimpleVector<Slot> slots_;
+    // Начало списка свободных слотов
+    size_t free_head_ = kNoSlot;
+};
@@ -0,0 +1,297 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <iterator>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include "simple_vector.h"
+
+namespace sort_detail {
+
+    // Количество бит в одном разряде поразрядной сортировки
+    constexpr size_t kRadixBits = 8;
+    constexpr size_t kRadixSize = size_t(1) << kRadixBits;
+
+    // Меньшие по размеру диапазоны сортируются в текущем потоке
+    constexpr size_t kParallelThreshold = size_t(1) << 14;
+
+    template<size_t Size>
+    struct UnsignedOfSize;
+
+    template<>
+    struct UnsignedOfSize<1> {
+        using type = uint8_t;
+    };
+
+    template<>
+    struct UnsignedOfSize<2> {
+        using type = uint16_t;
+    };
+
+    template<>
+    struct UnsignedOfSize<4> {
+        using type = uint32_t;
+    };
+
+    template<>
+    struct UnsignedOfSize<8> {
+        using type = uint64_t;
+    };
+
+    template<typename Key>
+    using RadixKey = typename UnsignedOfSize<sizeof(Key)>::type;
+
+    // Преобразует ключ в беззнаковое число, порядок которого совпадает с порядком исходных ключей.
+    // У знаковых целых инвертируется старший бит, у чисел с плавающей точкой отрицательные
+    // значения инвертируются целиком, а у положительных инвертируется только знаковый бит
+    template<typename Key>
+    RadixKey<Key> ToRadixKey(Key key) noexcept {
+        static_assert(std::is_arithmetic_v<Key>, "Radix sort key must be an arithmetic type");
+        using Bits = RadixKey<Key>;
+        constexpr Bits sign_bit = Bits(1) << (sizeof(Bits) * 8 - 1);
+
+        Bits bits;
+        std::memcpy(&bits, &key, sizeof(bits));
+        if constexpr (std::is_floating_point_v<Key>) {
+            return (bits & sign_bit) ? Bits(~bits) : Bits(bits | sign_bit);
+        } else if constexpr (std::is_signed_v<Key>) {
+            return Bits(bits ^ sign_bit);
+        } else {
+            return bits;
+        }
+    }
+
+    // Стабильно сливает отсортированные диапазоны [first1, last1) и [first2, last2), перемещая
+    // элементы в out. Компаратор получает исходные элементы, а не rvalue, поэтому
+    // компаратор, принимающий аргументы по значению, не опустошает их
+    template<typename Iterator, typename OutIterator, typename Compare>
+    OutIterator MoveMerge(Iterator first1, Iterator last1, Iterator first2, Iterator last2,
+                          OutIterator out, Compare &comp) {
+        while (first1 != last1 && first2 != last2) {
+            if (comp(*first2, *first1)) {
+                *out = std::move(*first2);
+                ++first2;
+            } else {
+                *out = std::move(*first1);
+                ++first1;
+            }
+            ++out;
+        }
+        out = std::move(first1, last1, out);
+        return std::move(first2, last2, out);
+    }
+
+    // Стабильно сливает отсортированные диапазоны [first1, last1) и [first2, last2) в out,
+    // разбивая работу между thread_count потоками
+    template<typename Iterator, typename OutIterator, typename Compare>
+    void ParallelMerge(Iterator first1, Iterator last1, Iterator first2, Iterator last2,
+                       OutIterator out, Compare comp, size_t thread_count) {
+        const size_t size1 = std::distance(first1, last1);
+        const size_t size2 = std::distance(first2, last2);
+        if (thread_count <= 1 || size1 + size2 < kParallelThreshold) {
+            MoveMerge(first1, last1, first2, last2, out, comp);
+            return;
+        }
+
+        // Делим больший диапазон пополам, а в меньшем ищем точку разреза так,
+        // чтобы равные элементы первого диапазона остались перед элементами второго
+        Iterator mid1, mid2;
+        if (size1 >= size2) {
+            mid1 = first1 + size1 / 2;
+            mid2 = std::lower_bound(first2, last2, *mid1, comp);
+        } else {
+            mid2 = first2 + size2 / 2;
+            mid1 = std::upper_bound(first1, last1, *mid2, comp);
+        }
+        OutIterator out_mid = out + (std::distance(first1, mid1) + std::distance(first2, mid2));
+
+        const size_t left_threads = thread_count / 2;
+        std::thread left([=] {
+            ParallelMerge(first1, mid1, first2, mid2, out, comp, left_threads);
+        });
+        ParallelMerge(mid1, last1, mid2, last2, out_mid, comp, thread_count - left_threads);
+        left.join();
+    }
+
+    // Сортирует data на thread_count частях, после чего попарно сливает их через buffer
+    template<typename Type, typename Compare, typename ChunkSort>
+    void ParallelMergeSort(SimpleVector<Type> &data, SimpleVector<Type> &buffer, Compare comp,
+                           size_t thread_count, ChunkSort chunk_sort) {
+        const size_t size = data.GetSize();
+        thread_count = std::min(std::max(thread_count, size_t(1)),
+                                std::max(size / kParallelThreshold, size_t(1)));
+        if (thread_count == 1) {
+            chunk_sort(data.begin(), data.end(), comp);
+            return;
+        }
+
+        SimpleVector<size_t> bounds(::Reserve(thread_count + 1));
+        for (size_t i = 0; i <= thread_count; ++i) {
+            bounds.PushBack(size * i / thread_count);
+        }
+
+        {
+            SimpleVector<std::thread> workers(::Reserve(thread_count));
+            for (size_t i = 0; i < thread_count; ++i) {
+                auto first = data.begin() + bounds[i];
+                auto last = data.begin() + bounds[i + 1];
+                workers.PushBack(std::thread([=] { chunk_sort(first, last, comp); }));
+            }
+            for (auto &worker: workers) {
+                worker.join();
+            }
+        }
+
+        if (buffer.GetSize() < size) {
+            buffer.ResizeDefaultInit(size);
+        }
+
+        // На каждом проходе части сливаются попарно, а потоки делятся между парами поровну
+        auto *from = data.begin();
+        auto *to = buffer.begin();
+        while (bounds.GetSize() > 2) {
+            const size_t runs = bounds.GetSize() - 1;
+            const size_t pairs = runs / 2;
+            const size_t threads_per_pair = std::max(thread_count / pairs, size_t(1));
+
+            SimpleVector<size_t> next_bounds(::Reserve(pairs + 2));
+            SimpleVector<std::thread> workers(::Reserve(pairs));
+            for (size_t i = 0; i + 1 < runs; i += 2) {
+                const size_t lo = bounds[i];
+                const size_t mid = bounds[i + 1];
+                const size_t hi = bounds[i + 2];
+                workers.PushBack(std::thread([=] {
+                    ParallelMerge(from + lo, from + mid, from + mid, from + hi, to + lo, comp, threads_per_pair);
+                }));
+                next_bounds.PushBack(lo);
+            }
+            if (runs % 2 == 1) {
+                const size_t lo = bounds[runs - 1];
+                std::move(from + lo, from + size, to + lo);
+                next_bounds.PushBack(lo);
+            }
+            next_bounds.PushBack(size);
+            for (auto &worker: workers) {
+                worker.join();
+            }
+
+            bounds.swap(next_bounds);
+            std::swap(from, to);
+        }
+
+        if (from != data.begin()) {
+            std::move(from, from + size, data.begin());
+        }
+    }
+
+} // namespace sort_detail
+
+// Сортирует элементы по ключу, возвращаемому key_of, поразрядной сортировкой (LSD).
+// Ключ должен быть целым числом или числом с плавающей точкой. Сортировка стабильна.
+// buffer используется как вспомогательный массив и может переиспользоваться между вызовами
+template<typename Type, typename KeyOf>
+void RadixSort(SimpleVector<Type> &data, SimpleVector<Type> &buffer, KeyOf key_of) {
+    using sort_detail::kRadixBits;
+    using sort_detail::kRadixSize;
+    using Key = std::decay_t<std::invoke_result_t<KeyOf &, const Type &>>;
+    constexpr size_t passes = sizeof(Key) * 8 / kRadixBits;
+
+    const size_t size = data.GetSize();
+    if (size < 2) {
+        return;
+    }
+    if (buffer.GetSize() < size) {
+        buffer.ResizeDefaultInit(size);
+    }
+
+    // Гистограммы всех разрядов строятся за один проход по данным
+    SimpleVector<size_t> counts(passes * kRadixSize);
+    for (const auto &item: data) {
+        auto key = sort_detail::ToRadixKey(key_of(item));
+        for (size_t pass = 0; pass < passes; ++pass) {
+            ++counts[pass * kRadixSize + ((key >> (pass * kRadixBits)) & (kRadixSize - 1))];
+        }
+    }
+
+    auto *from = data.begin();
+    auto *to = buffer.begin();
+    for (size_t pass = 0; pass < passes; ++pass) {
+        size_t *count = counts.begin() + pass * kRadixSize;
+        const size_t shift = pass * kRadixBits;
+
+        // Если у всех ключей разряд одинаковый, проход ничего не меняет
+        if (count[(sort_detail::ToRadixKey(key_of(*from)) >> shift) & (kRadixSize - 1)] == size) {
+            continue;
+        }
+
+        size_t offset = 0;
+        for (size_t digit = 0; digit < kRadixSize; ++digit) {
+            offset += std::exchange(count[digit], offset);
+        }
+        for (auto *it = from; it != from + size; ++it) {
+            const size_t digit = (sort_detail::ToRadixKey(key_of(*it)) >> shift) & (kRadixSize - 1);
+            to[count[digit]++] = std::move(*it);
+        }
+        std::swap(from, to);
+    }
+
+    if (from != data.begin()) {
+        std::move(from, from + size, data.begin());
+    }
+}
+
+template<typename Type, typename KeyOf>
+void RadixSort(SimpleVector<Type> &data, KeyOf key_of) {
+    SimpleVector<Type> buffer;
+    RadixSort(data, buffer, key_of);
+}
+
+// Сортирует целые числа или числа с плавающей точкой по возрастанию
+template<typename Type>
+void RadixSort(SimpleVector<Type> &data, SimpleVector<Type> &buffer) {
+    RadixSort(data, buffer, [](Type value) { return value; });
+}
+
+template<typename Type>
+void RadixSort(SimpleVector<Type> &data) {
+    SimpleVector<Type> buffer;
+    RadixSort(data, buffer);
+}
+
+// Сортирует элементы сортировкой слиянием на thread_count потоках.
+// Порядок равных элементов не сохраняется
+template<typename Type, typename Compare = std::less<>>
+void ParallelSort(SimpleVector<Type> &data, SimpleVector<Type> &buffer, Compare comp = Compare(),
+                  size_t thread_count = std::thread::hardware_concurrency()) {
+    sort_detail::ParallelMergeSort(data, buffer, comp, thread_count, [](auto first, auto last, Compare cmp) {
+        std::sort(first, last, cmp);
+    });
+}
+
+template<typename Type, typename Compare = std::less<>>
+void ParallelSort(SimpleVector<Type> &data, Compare comp = Compare(),
+                  size_t thread_count = std::thread::hardware_concurrency()) {
+    SimpleVector<Type> buffer;
+    ParallelSort(data, buffer, comp, thread_count);
+}
+
+// Сортирует элементы сортировкой слиянием на thread_count потоках.
+// Порядок равных элементов сохраняется
+template<typename Type, typename Compare = std::less<>>
+void ParallelStableSort(SimpleVector<Type> &data, SimpleVector<Type> &buffer, Compare comp = Compare(),
+                        size_t thread_count = std::thread::hardware_concurrency()) {
+    sort_detail::ParallelMergeSort(data, buffer, comp, thread_count, [](auto first, auto last, Compare cmp) {
+        std::stable_sort(first, last, cmp);
+    });
+}
+
+template<typename Type, typename Compare = std::less<>>
+void ParallelStableSort(SimpleVector<Type> &data, Compare comp = Compare(),
+                        size_t thread_count = std::thread::hardware_concurrency()) {
+    SimpleVector<Type> buffer;
+    ParallelStableSort(data, buffer, comp, thread_count);
+}
@@ -0,0 +1,154 @@
+#pragma once
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <system_error>
+#include <type_traits>
+#include <sys/uio.h>
+#include <unistd.h>
+#include "simple_vector.h"
+
+namespace vector_io_detail {
+
+    // Наименьшее количество байт, на которое увеличивается вместимость вектора перед чтением
+    constexpr size_t kMinReadSize = 4096;
+
+    // Размер буфера на стеке, в который ReadvAppend читает данные, не поместившиеся в вектор
+    constexpr size_t kStackBufferSize = 64 * 1024;
+
+    template<typename Byte>
+    constexpr void CheckByteType() {
+        static_assert(sizeof(Byte) == 1 && std::is_trivial_v<Byte>,
+                      "Vector I/O requires a vector of single-byte trivial elements");
+    }
+
+    // Увеличивает вместимость вектора так, чтобы в нём было место ещё хотя бы для одного байта,
+    // но не больше, чем для remaining байт. Вместимость растёт примерно вдвое
+    template<typename Byte>
+    void GrowForRead(SimpleVector<Byte> &vec, size_t remaining) {
+        if (vec.GetSize() == vec.GetCapacity()) {
+            vec.Reserve(vec.GetSize() + std::min(std::max(vec.GetCapacity(), kMinReadSize), remaining));
+        }
+    }
+
+    [[noreturn]] inline void ThrowErrno(const char *what) {
+        throw std::system_error(errno, std::generic_category(), what);
+    }
+
+    inline bool IsRetryable() {
+        return errno == EINTR;
+    }
+
+    inline bool WouldBlock() {
+        return errno == EAGAIN || errno == EWOULDBLOCK;
+    }
+
+} // namespace vector_io_detail
+
+// Результат чтения в вектор
+struct ReadResult {
+    // Количество прочитанных байт
+    size_t bytes = 0;
+    // true, если чтение остановилось на конце файла (для сокета — собеседник закрыл соединение).
+    // false, если прочитано max_bytes байт или неблокирующий дескриптор вернул EAGAIN
+    bool eof = false;
+};
+
+// Читает из файлового дескриптора fd в конец вектора не более max_bytes байт.
+// Данные читаются сразу в свободную часть вектора [end(), begin() + capacity),
+// вместимость которой при необходимости растёт вдвое. Чтение продолжается до конца файла,
+// пока не прочитано max_bytes байт или пока неблокирующий дескриптор не вернёт EAGAIN.
+// Возвращает количество прочитанных байт и признак конца файла. При ошибке выбрасывает
+// std::system_error, уже прочитанные данные остаются в векторе
+template<typename Byte>
+ReadResult ReadAppend(int fd, SimpleVector<Byte> &vec, size_t max_bytes = SIZE_MAX) {
+    vector_io_detail::CheckByteType<Byte>();
+    ReadResult result;
+    while (result.bytes < max_bytes) {
+        vector_io_detail::GrowForRead(vec, max_bytes - result.bytes);
+        const size_t size = vec.GetSize();
+        const size_t spare = std::min(vec.GetCapacity() - size, max_bytes - result.bytes);
+
+        const ssize_t count = ::read(fd, vec.end(), spare);
+        if (count < 0) {
+            if (vector_io_detail::IsRetryable()) continue;
+            if (vector_io_detail::WouldBlock()) break;
+            vector_io_detail::ThrowErrno("read");
+        }
+        if (count == 0) {
+            result.eof = true;
+            break;
+        }
+        vec.ResizeUninitialized(size + count);
+        result.bytes += count;
+    }
+    return result;
+}
+
+// То же, что ReadAppend, но свободная часть вектора и буфер на стеке заполняются одним
+// вызовом readv. Вектор растёт только тогда, когда данные действительно не поместились в него,
+// поэтому чтение небольших сообщений не требует заранее резервировать память
+template<typename Byte>
+ReadResult ReadvAppend(int fd, SimpleVector<Byte> &vec, size_t max_bytes = SIZE_MAX) {
+    vector_io_detail::CheckByteType<Byte>();
+    char stack_buffer[vector_io_detail::kStackBufferSize];
+    ReadResult result;
+    while (result.bytes < max_bytes) {
+        const size_t size = vec.GetSize();
+        const size_t remaining = max_bytes - result.bytes;
+        const size_t spare = std::min(vec.GetCapacity() - size, remaining);
+
+        iovec parts[2];
+        parts[0].iov_base = vec.end();
+        parts[0].iov_len = spare;
+        parts[1].iov_base = stack_buffer;
+        parts[1].iov_len = std::min(sizeof(stack_buffer), remaining - spare);
+
+        const ssize_t count = ::readv(fd, parts, 2);
+        if (count < 0) {
+            if (vector_io_detail::IsRetryable()) continue;
+            if (vector_io_detail::WouldBlock()) break;
+            vector_io_detail::ThrowErrno("readv");
+        }
+        if (count == 0) {
+            result.eof = true;
+            break;
+        }
+        result.bytes += count;
+
+        const size_t read = count;
+        if (read <= spare) {
+            vec.ResizeUninitialized(size + read);
+            continue;
+        }
+        vec.ResizeUninitialized(size + spare);
+        const size_t overflow = read - spare;
+        vec.Reserve(std::max(vec.GetCapacity() * 2, vec.GetSize() + overflow));
+        vec.ResizeUninitialized(vec.GetSize() + overflow);
+        std::memcpy(vec.end() - overflow, stack_buffer, overflow);
+    }
+    return result;
+}
+
+// Записывает содержимое вектора в файловый дескриптор fd, начиная с begin().
+// Запись продолжается, пока не записан весь вектор или пока неблокирующий дескриптор
+// не вернёт EAGAIN. Возвращает количество записанных байт: если оно меньше размера вектора,
+// оставшиеся байты нужно дописать, когда дескриптор снова станет доступен для записи.
+// При ошибке выбрасывает std::system_error
+template<typename Byte>
+size_t WriteAll(int fd, const SimpleVector<Byte> &vec) {
+    vector_io_detail::CheckByteType<Byte>();
+    size_t written = 0;
+    while (written < vec.GetSize()) {
+        const ssize_t count = ::write(fd, vec.begin() + written, vec.GetSize() - written);
+        if (count < 0) {
+            if (vector_io_detail::IsRetryable()) continue;
+            if (vector_io_detail::WouldBlock()) break;
+            vector_io_detail::ThrowErrno("write");
+        }
+        written += count;
+    }
+    return written;
+}